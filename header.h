@@ -8,8 +8,18 @@
 #include <chrono>
 #include <limits.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstring>
 #include <ctime>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <condition_variable>
+#include <cmath>
+#include <algorithm>
 #include <vector>
 #include <deque>
 #include <map>
@@ -24,7 +34,10 @@
 #include <opencv2/features2d.hpp>
 #include "checkers.h"
 #include "yolo_onnx.h"
+#include "publisher.h"
+#include "latency.h"
 #include "streams.h"
+#include "inference_pool.h"
 #include "security_camera.h"
 
 #endif
@@ -0,0 +1,100 @@
+#include "header.h"
+
+
+InferencePool::InferencePool(std::string path, cv::Size input_shape, float conf, float iou, int n_classes,
+int n_workers, int threads) : queues(__check_workers(n_workers)), max_in_flight(n_workers) {
+    if (threads == 0 && n_workers > 1)
+        threads = std::max(1, (int)std::thread::hardware_concurrency() / n_workers);  // share cores between sessions
+    for (int i = 0; i < n_workers; i++)
+        models.push_back(std::make_unique<ONNXYOLO>(path, input_shape, conf, iou, n_classes, threads));
+    for (int i = 0; i < n_workers; i++)
+        workers.push_back(std::thread([=] {__worker(i);}));
+    spdlog::info(fmt::format("Inference pool started with {} workers, {} threads each", n_workers, threads));
+}
+
+
+InferencePool::~InferencePool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+    }
+    task_cv.notify_all();
+    result_cv.notify_all();
+    for (std::thread &th : workers)
+        th.join();
+}
+
+
+int InferencePool::__check_workers(int n_workers) {
+    if (n_workers < 1)
+        throw std::runtime_error(fmt::format("Number of inference workers must be at least 1, but got {}", n_workers));
+    return n_workers;
+}
+
+
+void InferencePool::__worker(size_t index) {
+    while (true) {
+        InferenceResult task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            task_cv.wait(lock, [&] {return !running || !queues[index].empty();});
+            if (!running)
+                return;
+            task = std::move(queues[index].front());
+            queues[index].pop_front();
+        }
+        try {
+            task.bboxes = models[index]->predict(task.frame);
+        }
+        catch (const std::exception &e) {
+            // keep sequence going, frame is delivered without detections
+            spdlog::error(fmt::format("Inference of frame {} failed: {}", task.seq, e.what()));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            reorder[task.seq] = std::move(task);
+        }
+        result_cv.notify_all();
+    }
+}
+
+
+size_t InferencePool::in_flight() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return next_submit - next_deliver;
+}
+
+
+bool InferencePool::submit(cv::Mat &frame, FrameInfo &info) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (next_submit - next_deliver >= max_in_flight)
+            return false;  // pool is full, caller should deliver results first
+        InferenceResult task;
+        task.seq = next_submit++;
+        task.frame = frame;
+        task.info = info;
+        queues[task.seq % queues.size()].push_back(std::move(task));  // round-robin dispatch
+    }
+    task_cv.notify_all();
+    return true;
+}
+
+
+bool InferencePool::next(InferenceResult &result, bool wait) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto ready = [&] {return !reorder.empty() && reorder.begin()->first == next_deliver;};
+    if (wait)
+        result_cv.wait(lock, [&] {return !running || ready() || next_submit == next_deliver;});
+    if (!ready())
+        return false;  // next frame in order is not finished yet
+    result = std::move(reorder.begin()->second);
+    reorder.erase(reorder.begin());
+    next_deliver++;
+    return true;
+}
+
+
+void InferencePool::draw_bboxes(cv::Mat &frame, std::vector<Bbox> &boxes) const {
+    models[0]->draw_bboxes(frame, boxes);
+}
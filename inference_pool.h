@@ -0,0 +1,35 @@
+struct InferenceResult
+{
+    uint64_t seq = 0;  // number of submitted frame
+    cv::Mat frame;  // submitted frame
+    FrameInfo info;  // capture timestamp of frame
+    std::vector<Bbox> bboxes;  // yolo results
+};
+
+
+class InferencePool
+{
+private:
+    std::vector<std::unique_ptr<ONNXYOLO>> models;  // independent sessions, each with own input buffer
+    std::vector<std::thread> workers;  // single worker per session
+    std::vector<std::deque<InferenceResult>> queues;  // per-worker tasks
+    std::map<uint64_t, InferenceResult> reorder;  // finished results waiting for their turn
+    mutable std::mutex mtx;  // guards queues, reorder and counters
+    std::condition_variable task_cv, result_cv;
+    uint64_t next_submit = 0, next_deliver = 0;  // counters
+    size_t max_in_flight;  // backpressure limit, one frame per worker
+    bool running = true;
+
+    static int __check_workers(int);
+    void __worker(size_t);
+
+public:
+    InferencePool(std::string, cv::Size, float, float, int, int n_workers = 1, int threads = 0);
+    ~InferencePool();
+    size_t size() const {return models.size();}
+    size_t capacity() const {return max_in_flight;}
+    size_t in_flight() const;
+    bool submit(cv::Mat &, FrameInfo &);
+    bool next(InferenceResult &, bool wait = false);
+    void draw_bboxes(cv::Mat &, std::vector<Bbox> &) const;
+};
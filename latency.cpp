@@ -0,0 +1,43 @@
+#include "header.h"
+
+
+void LatencyHistogram::record(double value) {
+    size_t i = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();  // find bucket
+    counts[i]++;
+    total++;
+    if (threshold > 0 && value > threshold)
+        above++;  // counted exactly, bucket bounds may not match threshold
+    max_value = std::max(max_value, value);
+}
+
+
+double LatencyHistogram::percentile(double p) const {
+    if (total == 0)
+        return 0;
+    uint64_t target = std::ceil(p * total);  // rank of requested sample
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < bounds.size(); i++) {
+        accumulated += counts[i];
+        if (accumulated >= target)
+            return bounds[i];  // upper bound of bucket
+    }
+    return max_value;  // sample is in overflow bucket
+}
+
+
+std::string LatencyHistogram::format() const {
+    std::vector<std::string> buckets;
+    for (size_t i = 0; i < bounds.size(); i++)
+        buckets.push_back(fmt::format("<={:.0f}: {}", bounds[i], counts[i]));
+    buckets.push_back(fmt::format(">{:.0f}: {}", bounds.back(), counts.back()));
+    return fmt::format("[{}] p50 <= {:.0f}, p99 <= {:.0f}, max {:.1f}, above {:.0f}: {:.1f}%", fmt::join(buckets, ", "),
+    percentile(0.5), percentile(0.99), max_value, threshold, fraction_above() * 100);
+}
+
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    max_value = 0;
+    above = 0;
+}
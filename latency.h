@@ -0,0 +1,20 @@
+class LatencyHistogram
+{
+private:
+    std::vector<double> bounds {5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};  // upper bucket bounds in ms
+    std::vector<uint64_t> counts;  // bucket counters, last one for overflow
+    uint64_t total = 0;  // number of samples
+    double max_value = 0;  // max latency in ms
+    double threshold = 0;  // alarm threshold in ms
+    uint64_t above = 0;  // number of samples above threshold
+
+public:
+    LatencyHistogram(double threshold = 0) : counts(bounds.size() + 1, 0), threshold(threshold) {};
+    void record(double);
+    double percentile(double) const;
+    std::string format() const;
+    uint64_t size() const {return total;}
+    double fraction_above() const {return total > 0 ? (double)above / total : 0;}
+    double max() const {return max_value;}
+    void reset();
+};
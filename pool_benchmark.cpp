@@ -0,0 +1,44 @@
+#include "header.h"
+
+
+// Measures how InferencePool throughput scales with number of workers.
+static double __run(YAML::Node &config, cv::Size size, int n_workers, int n_frames) {
+    InferencePool pool(config["YOLO"]["model_path"].as<std::string>(), size, config["YOLO"]["confidence"].as<float>(),
+    config["YOLO"]["iou"].as<float>(), config["YOLO"]["n_classes"].as<int>(), n_workers, config["YOLO"]["threads"].as<int>(0));
+    cv::Mat frame(size, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    FrameInfo info;
+    InferenceResult result;
+    int submitted = 0, delivered = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (delivered < n_frames) {
+        if (submitted < n_frames && pool.submit(frame, info)) {
+            submitted++;
+            continue;
+        }
+        if (pool.next(result, true)) {
+            if (result.seq != (uint64_t)delivered)
+                throw std::runtime_error(fmt::format("Expected frame {}, but got {}", delivered, result.seq));
+            delivered++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return n_frames / seconds;
+}
+
+
+int main(int argc, char **argv) {
+    std::string config_file = argc > 1 ? argv[1] : "config.yaml";
+    int n_frames = argc > 2 ? std::stoi(argv[2]) : 200;
+    YAML::Node config = YAML::LoadFile(config_file);
+    cv::Size size(config["frame_w"].as<int>(), config["frame_h"].as<int>());
+    int max_workers = std::max(1, (int)std::thread::hardware_concurrency());
+    double base_fps = 0;
+    for (int n_workers = 1; n_workers <= max_workers; n_workers *= 2) {
+        double fps = __run(config, size, n_workers, n_frames);
+        if (n_workers == 1)
+            base_fps = fps;
+        std::cout << fmt::format("workers: {}, FPS: {:.2f}, speedup: {:.2f}x\n", n_workers, fps, fps / base_fps);
+    }
+    return 0;
+}
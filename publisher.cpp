@@ -0,0 +1,188 @@
+#include "header.h"
+
+
+static size_t __align(size_t size, size_t alignment = 64) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+
+SharedMemoryPublisher::SharedMemoryPublisher(std::string name, cv::Size size, int n_slots) :
+name(name), n_slots(n_slots) {
+    if (n_slots < 2)
+        throw std::runtime_error(fmt::format("Number of shared memory slots must be at least 2, but got {}", n_slots));
+    frame_size = size.area() * 3;  // frames are stored as CV_8UC3
+    slot_size = __align(sizeof(ShmSlotHeader)) + __align(frame_size);  // slot header followed by frame data
+    total_size = __align(sizeof(ShmRingHeader)) + slot_size * n_slots;
+    // create new shared memory object, readers attached to previous one keep it
+    if (shm_unlink(name.c_str()) == 0)
+        spdlog::warn(fmt::format("Replaced existing shared memory {}, another watcher may still publish to it", name));
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        throw std::runtime_error(fmt::format("Failed to open shared memory {}: {}", name, strerror(errno)));
+    if (ftruncate(fd, total_size) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error(fmt::format("Failed to resize shared memory {}: {}", name, strerror(errno)));
+    }
+    memory = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // mapping keeps the object alive
+    if (memory == MAP_FAILED) {
+        memory = nullptr;
+        shm_unlink(name.c_str());
+        throw std::runtime_error(fmt::format("Failed to map shared memory {}: {}", name, strerror(errno)));
+    }
+    // init ring layout
+    header = new (memory) ShmRingHeader;
+    header->n_slots = n_slots;
+    header->slot_size = slot_size;
+    header->frame_size = frame_size;
+    header->write_index.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < this->n_slots; i++) {
+        ShmSlotHeader *slot = new (__slot(i)) ShmSlotHeader;
+        slot->seq.store(0, std::memory_order_relaxed);
+        slot->n_boxes = 0;
+    }
+    header->magic.store(SHM_MAGIC, std::memory_order_release);  // readers may attach now
+    spdlog::info(fmt::format("Publishing frames to shared memory {} ({} slots, {} bytes)", name, n_slots, total_size));
+}
+
+
+ShmSlotHeader *SharedMemoryPublisher::__slot(size_t index) const {
+    char *base = (char *)memory + __align(sizeof(ShmRingHeader));
+    return (ShmSlotHeader *)(base + index * slot_size);
+}
+
+
+void SharedMemoryPublisher::publish(const cv::Mat &frame, const std::vector<Bbox> &bboxes,
+std::chrono::system_clock::time_point timestamp) {
+    if (memory == nullptr)
+        return;
+    if (frame.type() != CV_8UC3 || frame.total() * frame.elemSize() > frame_size)
+        throw std::runtime_error(fmt::format("Frame of {}x{} type {} does not fit shared memory slot", frame.cols, frame.rows, frame.type()));
+    uint64_t index = header->write_index.load(std::memory_order_relaxed);
+    ShmSlotHeader *slot = __slot(index % n_slots);
+    // mark slot as being written
+    uint64_t seq = slot->seq.load(std::memory_order_relaxed);
+    slot->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    // fill slot
+    slot->frame_id = index;
+    slot->timestamp = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count();
+    slot->width = frame.cols;
+    slot->height = frame.rows;
+    slot->type = frame.type();
+    slot->n_boxes = std::min(bboxes.size(), (size_t)SHM_MAX_BOXES);
+    for (uint32_t i = 0; i < slot->n_boxes; i++) {
+        const Bbox &box = bboxes[i];
+        slot->boxes[i] = ShmBbox{box.x, box.y, box.w, box.h, box.conf, box.cl};
+    }
+    cv::Mat data(frame.size(), frame.type(), (char *)slot + __align(sizeof(ShmSlotHeader)));
+    frame.copyTo(data);  // copy in place without reallocation
+    // publish slot
+    slot->seq.store(seq + 2, std::memory_order_release);
+    header->write_index.store(index + 1, std::memory_order_release);
+}
+
+
+void SharedMemoryPublisher::release() {
+    if (memory != nullptr) {
+        header->closed.store(1, std::memory_order_release);  // tell attached readers to reattach
+        munmap(memory, total_size);
+        shm_unlink(name.c_str());  // attached readers keep their mappings
+        memory = nullptr;
+        header = nullptr;
+    }
+}
+
+
+SharedMemorySubscriber::SharedMemorySubscriber(std::string name) : name(name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        throw std::runtime_error(fmt::format("Failed to open shared memory {}: {}", name, strerror(errno)));
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(ShmRingHeader)) {
+        close(fd);
+        throw std::runtime_error(fmt::format("Shared memory {} is not initialized", name));
+    }
+    total_size = info.st_size;
+    inode = info.st_ino;
+    memory = mmap(nullptr, total_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        memory = nullptr;
+        throw std::runtime_error(fmt::format("Failed to map shared memory {}: {}", name, strerror(errno)));
+    }
+    header = (const ShmRingHeader *)memory;
+    if (header->magic.load(std::memory_order_acquire) != SHM_MAGIC) {
+        release();
+        throw std::runtime_error(fmt::format("Shared memory {} has unknown layout", name));
+    }
+}
+
+
+const ShmSlotHeader *SharedMemorySubscriber::latest(uint64_t &seq) const {
+    uint64_t index = header->write_index.load(std::memory_order_acquire);
+    if (index == 0)  // nothing published yet
+        return nullptr;
+    const char *base = (const char *)memory + __align(sizeof(ShmRingHeader));
+    const ShmSlotHeader *slot = (const ShmSlotHeader *)(base + (index - 1) % header->n_slots * header->slot_size);
+    seq = slot->seq.load(std::memory_order_acquire);
+    if (seq & 1)  // producer already overwrites this slot
+        return nullptr;
+    return slot;
+}
+
+
+cv::Mat SharedMemorySubscriber::view(const ShmSlotHeader *slot) const {
+    // wrap slot memory without copying, valid until validate() fails
+    int32_t width = slot->width, height = slot->height, type = slot->type;
+    if (type != CV_8UC3 || width <= 0 || height <= 0 ||
+    (uint64_t)width * height * CV_ELEM_SIZE(type) > header->frame_size)
+        return cv::Mat();  // torn header, validate() will fail
+    return cv::Mat(height, width, type, (char *)slot + __align(sizeof(ShmSlotHeader)));
+}
+
+
+std::vector<Bbox> SharedMemorySubscriber::boxes(const ShmSlotHeader *slot) const {
+    std::vector<Bbox> result;
+    uint32_t n_boxes = std::min(slot->n_boxes, (uint32_t)SHM_MAX_BOXES);
+    for (uint32_t i = 0; i < n_boxes; i++) {
+        const ShmBbox &box = slot->boxes[i];
+        result.push_back(Bbox(box.x, box.y, box.w, box.h, box.conf, box.cl));
+    }
+    return result;
+}
+
+
+bool SharedMemorySubscriber::validate(const ShmSlotHeader *slot, uint64_t seq) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->seq.load(std::memory_order_relaxed) == seq;  // slot was not touched while reading
+}
+
+
+bool SharedMemorySubscriber::closed() const {
+    if (header->closed.load(std::memory_order_acquire))
+        return true;  // publisher released ring
+    // publisher may have crashed and been restarted with new ring under same name
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_checked < std::chrono::seconds(1))
+        return false;  // limit syscalls on idle polling
+    last_checked = now;
+    struct stat info;
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;  // no new ring yet, keep current one
+    bool replaced = fstat(fd, &info) == 0 && info.st_ino != inode;
+    close(fd);
+    return replaced;
+}
+
+
+void SharedMemorySubscriber::release() {
+    if (memory != nullptr) {
+        munmap(memory, total_size);
+        memory = nullptr;
+        header = nullptr;
+    }
+}
@@ -0,0 +1,74 @@
+#define SHM_MAGIC 0x53434D52  // "SCMR"
+#define SHM_MAX_BOXES 64  // max number of boxes stored per frame
+
+
+struct ShmBbox
+{
+    float x, y, w, h, conf;
+    int32_t cl;
+};
+
+
+struct ShmSlotHeader
+{
+    std::atomic<uint64_t> seq;  // seqlock counter, odd while slot is being written
+    uint64_t frame_id;  // number of published frame
+    int64_t timestamp;  // frame capture time in microseconds since epoch
+    int32_t width, height, type;  // frame layout
+    uint32_t n_boxes;  // number of valid boxes
+    ShmBbox boxes[SHM_MAX_BOXES];  // detections
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory ring requires lock-free 32-bit atomics");
+
+
+struct ShmRingHeader
+{
+    std::atomic<uint32_t> magic;  // layout marker, set when ring is initialized
+    std::atomic<uint32_t> closed;  // set when publisher released ring
+    uint32_t n_slots;  // number of slots in ring
+    uint64_t slot_size;  // size of single slot in bytes including header
+    uint64_t frame_size;  // max size of frame data in bytes
+    std::atomic<uint64_t> write_index;  // number of frames published so far
+};
+
+
+class SharedMemoryPublisher
+{
+private:
+    std::string name;  // name of shared memory object
+    size_t n_slots = 0, frame_size = 0, slot_size = 0, total_size = 0;  // ring layout
+    void *memory = nullptr;  // mapped region
+    ShmRingHeader *header = nullptr;  // ring header
+
+    ShmSlotHeader *__slot(size_t) const;
+
+public:
+    SharedMemoryPublisher(std::string, cv::Size, int n_slots = 8);
+    SharedMemoryPublisher() {};
+    void publish(const cv::Mat &, const std::vector<Bbox> &,
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+    void release();
+};
+
+
+class SharedMemorySubscriber
+{
+private:
+    std::string name;  // name of shared memory object
+    size_t total_size = 0;  // size of mapped region
+    void *memory = nullptr;  // mapped region
+    const ShmRingHeader *header = nullptr;  // ring header
+    ino_t inode = 0;  // identity of mapped object
+    mutable std::chrono::steady_clock::time_point last_checked;  // last check of object identity
+
+public:
+    SharedMemorySubscriber(std::string);
+    SharedMemorySubscriber() {};
+    const ShmSlotHeader *latest(uint64_t &) const;
+    cv::Mat view(const ShmSlotHeader *) const;
+    std::vector<Bbox> boxes(const ShmSlotHeader *) const;
+    bool validate(const ShmSlotHeader *, uint64_t) const;
+    bool closed() const;
+    void release();
+};
@@ -22,14 +22,26 @@ SecurityCamera::SecurityCamera(std::string config_file) {
     // VideoRecording
     recording = VideoRecording(config["VIDEO"]["outdir"].as<std::string>(), 60, 600);
     // VideoCapture
-    cap = new CustomVideoCapture(config["source"].as<std::string>());
+    YAML::Node capture = config["CAPTURE"] ? config["CAPTURE"] : YAML::Node(YAML::NodeType::Map);  // optional section
+    cap = new CustomVideoCapture(config["source"].as<std::string>(), capture["max_frame_age_ms"].as<int>(1000),
+    capture["stall_timeout_ms"].as<int>(3000), capture["retry_initial_ms"].as<int>(100),
+    capture["retry_max_ms"].as<int>(5000));
     // YOLO
     float iou = config["YOLO"]["iou"].as<float>();
     float confidence = config["YOLO"]["confidence"].as<float>();
     std::string model_path = config["YOLO"]["model_path"].as<std::string>();
-    yolo = new ONNXYOLO(model_path, size, confidence, iou, config["YOLO"]["n_classes"].as<int>());
+    yolo = new InferencePool(model_path, size, confidence, iou, config["YOLO"]["n_classes"].as<int>(),
+    config["YOLO"]["workers"].as<int>(1), config["YOLO"]["threads"].as<int>(0));  // optional, single session by default
+    // Shared memory publisher
+    if (config["PUBLISHER"] && config["PUBLISHER"]["enabled"].as<bool>())
+        publisher = new SharedMemoryPublisher(config["PUBLISHER"]["name"].as<std::string>(), size,
+        config["PUBLISHER"]["slots"].as<int>());
     // Other params
     print_fps = config["print_fps"].as<bool>();
+    YAML::Node latency_config = config["LATENCY"] ? config["LATENCY"] : YAML::Node(YAML::NodeType::Map);  // optional section
+    latency_period = latency_config["print_every"].as<int>(10);
+    latency_warn = latency_config["warn_ms"].as<int>(1000);
+    latency = LatencyHistogram(latency_warn);
     record_video = config["record_video"].as<bool>();
     checker = config["ORBChecker"].as<bool>();
 }
@@ -37,6 +49,11 @@ SecurityCamera::SecurityCamera(std::string config_file) {
 
 void SecurityCamera::release() {
     delete yolo;
+    if (publisher != nullptr) {
+        publisher->release();
+        delete publisher;
+        publisher = nullptr;
+    }
     cap->release();
     recording.release();
 }
@@ -58,6 +75,26 @@ void SecurityCamera::__print_fps() {
 }
 
 
+void SecurityCamera::__print_latency() {
+    if (latency_period <= 0)
+        return;
+    auto now = std::chrono::system_clock::now();
+    if (std::chrono::duration<double>(now - latency_logged).count() < latency_period)
+        return;
+    if (latency.size() > 0) {
+        std::string msg = fmt::format("Capture-to-decision latency ms: {}", latency.format());
+        if (latency.fraction_above() > 0.01)  // p99 exceeds warn_ms
+            spdlog::warn(msg);  // decisions lag behind real time
+        else
+            spdlog::info(msg);
+    }
+    else
+        spdlog::warn("No fresh frames to process");
+    latency.reset();
+    latency_logged = now;
+}
+
+
 void SecurityCamera::__draw_info(cv::Mat &frame) {
     if (bboxes.size() > 0)
         yolo->draw_bboxes(frame, bboxes);
@@ -66,35 +103,63 @@ void SecurityCamera::__draw_info(cv::Mat &frame) {
 }
 
 
+bool SecurityCamera::__process(InferenceResult &result) {
+    __print_fps();
+    cv::Mat frame = result.frame;
+    cv::Mat rec_frame;
+    frame.copyTo(rec_frame);  // copy frame to record
+    bboxes = result.bboxes;
+    // Process checker
+    if (checker)
+        obscured = orb.step(frame);
+    
+    // Process recording
+    if (record_video)
+        recording.record(rec_frame, bboxes.size() != 0);
+    
+    // Publish results to local readers
+    if (publisher != nullptr)
+        publisher->publish(rec_frame, bboxes, result.info.wall);
+
+    // Decision is made, track its latency
+    latency.record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - result.info.decoded).count());
+
+    // FOR DEBUG //
+    
+    __draw_info(frame);
+    cv::imshow("Camera", frame);
+    if ((cv::waitKey(25) & 0xEFFFFF) == 27) {
+        cv::destroyWindow("Camera");
+        return false;
+    }
+    return true;
+}
+
+
 void SecurityCamera::watch() {
     while (true) {
-        __print_fps();
-        // Init buffers
-        cv::Mat frame;
-        cv::Mat rec_frame;
-        bool ret = cap->read(frame);  // read frame
-        if (!ret)
+        __print_latency();
+        InferenceResult result;
+        if (yolo->in_flight() < yolo->capacity()) {
+            // Submit fresh frame only when some worker is idle, so frames never wait in queue
+            cv::Mat frame;
+            FrameInfo info;
+            bool submitted = false;
+            bool ret = cap->read(frame, info);  // read fresh frame
+            if (ret && info.id != last_frame_id) {
+                last_frame_id = info.id;
+                cv::resize(frame, frame, size);  // resize frame
+                submitted = yolo->submit(frame, info);
+            }
+            if (!yolo->next(result)) {
+                if (!submitted)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));  // wait for new frame
+                continue;
+            }
+        }
+        else if (!yolo->next(result, true))  // all workers are busy, wait for next result in order
             continue;
-        cv::resize(frame, frame, size);  // resize frame
-        frame.copyTo(rec_frame);  // copy frame to record
-        // Process yolo
-        bboxes = yolo->predict(frame);
-        // Process checker
-        if (checker)
-            obscured = orb.step(frame);
-        
-        // Process recording
-        if (record_video)
-            recording.record(rec_frame, bboxes.size() != 0);
-        
-        // FOR DEBUG //
-        
-        __draw_info(frame);
-        cv::imshow("Camera", frame);
-        if ((cv::waitKey(25) & 0xEFFFFF) == 27) {
-            cv::destroyWindow("Camera");
+        if (!__process(result))
             break;
-        }
-        
     }
 }
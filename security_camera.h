@@ -8,13 +8,20 @@ private:
     std::vector<Bbox> bboxes;  // yolo results
     ORBChecker orb;  // obscureness checker
     VideoRecording recording;  // record video
-    ONNXYOLO *yolo;  // yolo model
+    InferencePool *yolo;  // yolo models
+    SharedMemoryPublisher *publisher = nullptr;  // publish results to local readers
+    LatencyHistogram latency;  // capture-to-decision latency
+    uint64_t last_frame_id = 0;  // last processed frame
+    int latency_period, latency_warn;  // latency reporting params
     bool obscured = false, print_fps, record_video, checker;  // flag for obscureness
     int direction = 0;
     std::chrono::_V2::system_clock::time_point last_logged = std::chrono::system_clock::now();  // timers
+    std::chrono::_V2::system_clock::time_point latency_logged = std::chrono::system_clock::now();
 
     void __draw_info(cv::Mat &);
     void __print_fps();
+    void __print_latency();
+    bool __process(InferenceResult &);
 
 public:
     SecurityCamera(std::string);
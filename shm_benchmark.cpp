@@ -0,0 +1,61 @@
+#include "header.h"
+
+
+// Measures latency of SharedMemoryPublisher::publish with and without concurrent readers.
+static void __run(SharedMemoryPublisher &publisher, cv::Mat &frame, std::vector<Bbox> &bboxes, int iterations, int n_readers) {
+    std::atomic<bool> running {true};
+    std::vector<std::thread> readers;
+    std::atomic<uint64_t> read_count {0}, checksum {0};
+    std::atomic<int> attached {0};
+    for (int i = 0; i < n_readers; i++) {
+        readers.push_back(std::thread([&] {
+            SharedMemorySubscriber subscriber("/security_camera_bench");
+            attached++;
+            while (running.load()) {
+                uint64_t seq;
+                const ShmSlotHeader *slot = subscriber.latest(seq);
+                cv::Mat view;
+                if (slot != nullptr)
+                    view = subscriber.view(slot);
+                if (view.empty()) {
+                    std::this_thread::yield();  // do not compete with producer while waiting
+                    continue;
+                }
+                uint64_t brightness = cv::mean(view)[0];
+                if (subscriber.validate(slot, seq)) {
+                    read_count++;
+                    checksum += brightness;  // consume result so it is not optimized out
+                }
+            }
+            subscriber.release();
+        }));
+    }
+    while (attached.load() < n_readers)
+        std::this_thread::yield();  // time only iterations with all readers attached
+    std::vector<double> latency(iterations);
+    for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        publisher.publish(frame, bboxes);
+        latency[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    running = false;
+    for (std::thread &th : readers)
+        th.join();
+    std::sort(latency.begin(), latency.end());
+    std::cout << fmt::format("readers: {}, publish latency us p50: {:.1f}, p99: {:.1f}, max: {:.1f}, consistent reads: {}, checksum: {}\n",
+    n_readers, latency[iterations / 2], latency[iterations * 99 / 100], latency.back(), read_count.load(), checksum.load());
+}
+
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 10000;
+    cv::Size size(640, 384);
+    cv::Mat frame(size, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(255));
+    std::vector<Bbox> bboxes(10, Bbox(0.5, 0.5, 0.1, 0.2, 0.9, 0));
+    SharedMemoryPublisher publisher("/security_camera_bench", size, 8);
+    for (int n_readers : {0, 1, 4})
+        __run(publisher, frame, bboxes, iterations, n_readers);
+    publisher.release();
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "header.h"
+
+
+// Attach to ring, waiting until watcher has created it.
+static SharedMemorySubscriber __attach(std::string &name) {
+    while (true) {
+        try {
+            return SharedMemorySubscriber(name);
+        }
+        catch (const std::runtime_error &) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));  // watcher is not running yet
+        }
+    }
+}
+
+
+// Example of local consumer: attaches to the ring published by watcher and shows the latest frames.
+int main(int argc, char **argv) {
+    std::string config_file = argc > 1 ? argv[1] : "config.yaml";
+    YAML::Node config = YAML::LoadFile(config_file);
+    std::string name = config["PUBLISHER"]["name"].as<std::string>();
+    SharedMemorySubscriber subscriber = __attach(name);
+    uint64_t last_frame_id = UINT64_MAX;
+    cv::Mat frame;
+    while (true) {
+        uint64_t seq;
+        const ShmSlotHeader *slot = subscriber.latest(seq);
+        if (slot == nullptr || slot->frame_id == last_frame_id) {
+            if (subscriber.closed()) {
+                // watcher released or replaced ring, attach to the new one
+                spdlog::warn(fmt::format("Shared memory {} was closed, reattaching", name));
+                subscriber.release();
+                subscriber = __attach(name);
+                last_frame_id = UINT64_MAX;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));  // wait for new frame
+            continue;
+        }
+        uint64_t frame_id = slot->frame_id;
+        cv::Mat view = subscriber.view(slot);  // no copy, points into shared memory
+        if (view.empty())
+            continue;  // slot is being overwritten
+        double brightness = cv::mean(view)[0];
+        std::vector<Bbox> bboxes = subscriber.boxes(slot);
+        view.copyTo(frame);  // copy only because we draw on it
+        if (!subscriber.validate(slot, seq))
+            continue;  // slot was overwritten while reading, take the next one
+        last_frame_id = frame_id;
+        spdlog::info(fmt::format("Frame {}: {} boxes, brightness {:.1f}", frame_id, bboxes.size(), brightness));
+        for (Bbox &box : bboxes)
+            cv::rectangle(frame, box.toDraw(frame.cols, frame.rows), cv::Scalar(0, 255, 0), 2);
+        cv::imshow("Reader", frame);
+        if ((cv::waitKey(1) & 0xEFFFFF) == 27) {
+            cv::destroyWindow("Reader");
+            break;
+        }
+    }
+    subscriber.release();
+    return 0;
+}
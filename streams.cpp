@@ -1,33 +1,80 @@
 #include "header.h"
 
 
-CustomVideoCapture::CustomVideoCapture(std::string name) : 
-name(name), cap(cv::VideoCapture(name)) {
+CustomVideoCapture::CustomVideoCapture(std::string name, int max_frame_age, int stall_timeout,
+int retry_initial, int retry_max) :
+name(name), max_frame_age(max_frame_age), stall_timeout(stall_timeout),
+retry_initial(retry_initial), retry_max(retry_max) {
+    __open();
     th = std::thread([=] {__reader();});
 }
 
 
-void CustomVideoCapture::__reader() {
-    while (true) {
-        ret = cap.read(frame);  // try to read frame
-        if (!ret) {
-            std::this_thread::sleep_for(std::chrono::seconds(5));  // slep for 5 seconds if no frame
-            cap.release();
-            std::string msg = fmt::format("Attempt to reconnect to camera {}", name);
+void CustomVideoCapture::__open() {
+    // bound open and read calls so stalled stream does not block reader forever, timeouts are FFmpeg-only
+    cap = cv::VideoCapture(name, cv::CAP_FFMPEG, {cv::CAP_PROP_OPEN_TIMEOUT_MSEC, stall_timeout,
+    cv::CAP_PROP_READ_TIMEOUT_MSEC, stall_timeout});
+    if (!cap.isOpened()) {
+        cap = cv::VideoCapture(name);  // fall back to any backend
+        if (cap.isOpened()) {
+            std::string msg = fmt::format("Camera {} is opened without FFmpeg, stalled reads are not bounded", name);
             spdlog::warn(msg);
-            cap = cv::VideoCapture(name);  // reopen stream
         }
     }
 }
 
 
-bool CustomVideoCapture::read(cv::Mat &image) const {
+void CustomVideoCapture::__reader() {
+    int backoff = retry_initial;  // current delay before reconnection
+    while (running) {
+        cv::Mat buf;
+        bool success = cap.isOpened() && cap.read(buf);  // try to read frame
+        if (success) {
+            // timestamp frame right after decoding
+            std::lock_guard<std::mutex> lock(mtx);
+            frame = buf;
+            info.id++;
+            info.decoded = std::chrono::steady_clock::now();
+            info.wall = std::chrono::system_clock::now();
+            ret = true;
+            backoff = retry_initial;  // stream is alive, reset backoff
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ret = false;
+        }
+        std::string msg = fmt::format("Attempt to reconnect to camera {} in {} ms", name, backoff);
+        spdlog::warn(msg);
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoff));  // fast retry with exponential backoff
+        cap.release();
+        if (!running)
+            break;
+        __open();  // reopen stream
+        backoff = std::min(backoff * 2, retry_max);
+    }
+}
+
+
+bool CustomVideoCapture::read(cv::Mat &image, FrameInfo &frame_info) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!ret)
+        return false;
+    double age = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - info.decoded).count();
+    if (max_frame_age > 0 && age > max_frame_age)
+        return false;  // reject stale frame
     frame.copyTo(image);
-    return ret;
+    frame_info = info;
+    return true;
 }
 
 
-void CustomVideoCapture::release() {cap.release();}
+void CustomVideoCapture::release() {
+    running = false;
+    if (th.joinable())
+        th.join();
+    cap.release();
+}
 
 
 void CustomVideoWriter::release() {
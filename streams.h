@@ -1,17 +1,31 @@
+struct FrameInfo
+{
+    uint64_t id = 0;  // number of decoded frame
+    std::chrono::steady_clock::time_point decoded;  // when frame was decoded, for age computing
+    std::chrono::system_clock::time_point wall;  // same moment in wall clock time
+};
+
+
 class CustomVideoCapture
 {
 private:
     cv::VideoCapture cap;  // default videocapture object
     std::string name;  // name of source
     cv::Mat frame;  // placeholder for frame
+    FrameInfo info;  // timestamp of frame
     bool ret = false;  // if frame was read
+    int max_frame_age, stall_timeout, retry_initial, retry_max;  // params in milliseconds
+    mutable std::mutex mtx;  // guards frame, info and ret
+    std::atomic<bool> running {true};  // state of reader
+    void __open();  // (re)open stream
     void __reader();  // threading function
     std::thread th;
 
 public:
-    CustomVideoCapture(std::string);
+    CustomVideoCapture(std::string, int max_frame_age = 1000, int stall_timeout = 3000,
+    int retry_initial = 100, int retry_max = 5000);
     CustomVideoCapture() {};
-    bool read(cv:: Mat &) const;
+    bool read(cv::Mat &, FrameInfo &) const;
     void release();
 };
 
@@ -10,11 +10,13 @@ cv::Rect Bbox::toDraw(int width, int height) const {
 }
 
 
-ONNXYOLO::ONNXYOLO(std::string path, cv::Size input_shape, float conf, float iou, int n_classes) :
+ONNXYOLO::ONNXYOLO(std::string path, cv::Size input_shape, float conf, float iou, int n_classes, int threads) :
 input_shape(input_shape), conf(conf), iou(iou), n_classes(n_classes) {
     spdlog::info("Setting up model...");
     env = Ort::Env(ORT_LOGGING_LEVEL_WARNING);  // init enviroment
     sessionOptions = Ort::SessionOptions();  // set session options
+    if (threads > 0)
+        sessionOptions.SetIntraOpNumThreads(threads);  // limit threads when several sessions share CPU
     session = Ort::Session(env, path.c_str(), sessionOptions);  // set session
     input_names.reserve(1);  // reserve memory for input names and output names
     output_names.reserve(1);
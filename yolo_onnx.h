@@ -34,7 +34,7 @@ private:
     void __preprocess(cv::Mat &);
 
 public:
-    ONNXYOLO(std::string, cv::Size, float, float, int);
+    ONNXYOLO(std::string, cv::Size, float, float, int, int threads = 0);
     ~ONNXYOLO();
     ONNXYOLO();
     std::vector<Bbox> predict(cv::Mat &);